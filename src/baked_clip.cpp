@@ -0,0 +1,199 @@
+#define LUMIX_NO_CUSTOM_CRT
+#include "baked_clip.h"
+#include "core/math.h"
+#include "core/stream.h"
+#include <algorithm>
+
+namespace Lumix {
+
+void BakedClip::evaluate(size_t track_idx, float time, float* out) const
+{
+	const BakedTrack& track = tracks[track_idx];
+	float frame = clamp(time * sample_rate, 0.0f, float(frame_count));
+	if (track.baked)
+		evaluateBaked(track, frame, out);
+	else
+		evaluateKeyed(track, frame, out);
+	finalize(track, out);
+}
+
+void BakedClip::evaluateBaked(const BakedTrack& track, float frame, float* out) const
+{
+	size_t i = size_t(frame);
+	float t = frame - i;
+	const u16* row = samples.data() + i * stride + track.column;
+	for (u32 c = 0; c < track.components; ++c)
+	{
+		float a = row[c];
+		float b = row[c + stride];
+		out[c] = track.min[c] + (a + (b - a) * t) * track.scale[c];
+	}
+}
+
+void BakedClip::evaluateKeyed(const BakedTrack& track, float frame, float* out)
+{
+	const u32 n = track.components;
+	if (track.frames.empty())
+	{
+		for (u32 c = 0; c < n; ++c) out[c] = 0;
+		return;
+	}
+
+	auto it = std::upper_bound(track.frames.begin(), track.frames.end(), frame);
+	if (it == track.frames.begin() || it == track.frames.end())
+	{
+		size_t key = it == track.frames.begin() ? 0 : track.frames.size() - 1;
+		for (u32 c = 0; c < n; ++c) out[c] = track.values[key * n + c];
+		return;
+	}
+
+	size_t b = it - track.frames.begin();
+	size_t a = b - 1;
+	float t = (frame - track.frames[a]) / float(track.frames[b] - track.frames[a]);
+	for (u32 c = 0; c < n; ++c)
+	{
+		float va = track.values[a * n + c];
+		float vb = track.values[b * n + c];
+		out[c] = va + (vb - va) * t;
+	}
+}
+
+void BakedClip::finalize(const BakedTrack& track, float* out)
+{
+	if (track.type == ValueType::Int)
+	{
+		out[0] = float(int(out[0] + (out[0] < 0 ? -0.5f : 0.5f)));
+	}
+	else if (track.type == ValueType::Quat)
+	{
+		// keys are kept on one hemisphere, so only a zero quaternion keyed by the user can get here
+		float sq_len = out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3];
+		Quat q = sq_len > 1e-12f ? Quat(out[0], out[1], out[2], out[3]) : Quat(0, 0, 0, 1);
+		q.normalize();
+		out[0] = q.x;
+		out[1] = q.y;
+		out[2] = q.z;
+		out[3] = q.w;
+	}
+}
+
+u32 BakedClip::getComponentCount(ValueType type)
+{
+	switch (type)
+	{
+		case ValueType::Float: return 1;
+		case ValueType::Int: return 1;
+		case ValueType::Vec2: return 2;
+		case ValueType::Vec3: return 3;
+		case ValueType::Quat: return 4;
+	}
+	ASSERT(false);
+	return 1;
+}
+
+u64 BakedClip::keyedSize(const BakedTrack& track)
+{
+	return track.frames.size() * (sizeof(int) + track.components * sizeof(float));
+}
+
+u64 BakedClip::bakedSize(const BakedTrack& track) const
+{
+	return getRowCount() * track.components * sizeof(u16) + 2 * track.components * sizeof(float);
+}
+
+void BakedClip::serialize(OutputMemoryStream& blob) const
+{
+	blob.write(MAGIC);
+	blob.write(Version::LATEST);
+	blob.write(frame_count);
+	blob.write(sample_rate);
+	blob.write(stride);
+	blob.write(u32(tracks.size()));
+	for (const BakedTrack& track : tracks)
+	{
+		blob.write(u32(track.type));
+		blob.write(u8(track.baked ? 1 : 0));
+		blob.write(track.components);
+		if (track.baked)
+		{
+			blob.write(track.column);
+			blob.write(track.min, sizeof(float) * track.components);
+			blob.write(track.scale, sizeof(float) * track.components);
+		}
+		else
+		{
+			blob.write(u32(track.frames.size()));
+			blob.write(track.frames.data(), track.frames.size() * sizeof(int));
+			blob.write(track.values.data(), track.values.size() * sizeof(float));
+		}
+	}
+	blob.write(u32(samples.size()));
+	blob.write(samples.data(), samples.size() * sizeof(u16));
+}
+
+bool BakedClip::deserialize(InputMemoryStream& blob)
+{
+	u32 magic;
+	Version version;
+	u32 track_count;
+	if (blob.remaining() < sizeof(magic) + sizeof(version)) return false;
+	blob.read(magic);
+	blob.read(version);
+	if (magic != MAGIC || version > Version::LATEST) return false;
+
+	if (blob.remaining() < sizeof(frame_count) + sizeof(sample_rate) + sizeof(stride) + sizeof(track_count)) return false;
+	blob.read(frame_count);
+	blob.read(sample_rate);
+	blob.read(stride);
+	blob.read(track_count);
+	if (frame_count < 0 || sample_rate <= 0) return false;
+
+	const u64 track_header_size = sizeof(u32) + sizeof(u8) + sizeof(u32);
+	if (blob.remaining() < u64(track_count) * track_header_size) return false;
+	tracks.clear();
+	tracks.resize(track_count);
+	for (BakedTrack& track : tracks)
+	{
+		u32 type;
+		u8 baked;
+		if (blob.remaining() < track_header_size) return false;
+		blob.read(type);
+		blob.read(baked);
+		blob.read(track.components);
+		if (type > u32(ValueType::Quat) || baked > 1) return false;
+		track.type = ValueType(type);
+		track.baked = baked != 0;
+		if (track.components != getComponentCount(track.type)) return false;
+
+		if (track.baked)
+		{
+			if (blob.remaining() < sizeof(track.column) + 2 * sizeof(float) * track.components) return false;
+			blob.read(track.column);
+			blob.read(track.min, sizeof(float) * track.components);
+			blob.read(track.scale, sizeof(float) * track.components);
+			if (u64(track.column) + track.components > stride) return false;
+		}
+		else
+		{
+			u32 key_count;
+			if (blob.remaining() < sizeof(key_count)) return false;
+			blob.read(key_count);
+			if (blob.remaining() < u64(key_count) * (sizeof(int) + track.components * sizeof(float))) return false;
+			track.frames.resize(key_count);
+			track.values.resize(u64(key_count) * track.components);
+			blob.read(track.frames.data(), track.frames.size() * sizeof(int));
+			blob.read(track.values.data(), track.values.size() * sizeof(float));
+		}
+	}
+
+	u32 sample_count;
+	if (blob.remaining() < sizeof(sample_count)) return false;
+	blob.read(sample_count);
+	if (u64(sample_count) != getRowCount() * stride) return false;
+	if (blob.remaining() < u64(sample_count) * sizeof(u16)) return false;
+	samples.resize(sample_count);
+	blob.read(samples.data(), samples.size() * sizeof(u16));
+	return true;
+}
+
+} // namespace Lumix
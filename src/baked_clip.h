@@ -0,0 +1,72 @@
+#pragma once
+#include "core/core.h"
+#include <vector>
+
+namespace Lumix {
+
+struct InputMemoryStream;
+struct OutputMemoryStream;
+
+// Animation clip in its shipping form. Each track is either kept as sparse keys sorted by frame or resampled once per
+// frame into a frame-major buffer of u16 samples quantized to the track's value range, so evaluating a baked track is
+// one strided row read and one lerp.
+struct BakedClip
+{
+	enum class ValueType : u32
+	{
+		Float,
+		Int,
+		Vec2,
+		Vec3,
+		Quat
+	};
+
+	enum class Version : u32
+	{
+		FIRST,
+
+		LATEST
+	};
+
+	static constexpr u32 MAGIC = 0x43425050; // 'PPBC'
+
+	struct BakedTrack
+	{
+		ValueType type = ValueType::Float;
+		bool baked = false;
+		u32 components = 0;
+		// baked - column of the first component within a frame row, value = min + sample * scale
+		u32 column = 0;
+		float min[4] = {};
+		float scale[4] = {};
+		// keyed - keys sorted by frame, values flattened to `components` floats per key
+		std::vector<int> frames;
+		std::vector<float> values;
+	};
+
+	int frame_count = 0;
+	int sample_rate = 0;
+	u32 stride = 0;
+	std::vector<BakedTrack> tracks;
+	// getRowCount() rows of `stride` samples, last row duplicated so frame + 1 is always readable
+	std::vector<u16> samples;
+
+	// Writes the value of track at time (seconds) to out, getComponentCount(type) floats
+	void evaluate(size_t track_idx, float time, float* out) const;
+	void evaluateBaked(const BakedTrack& track, float frame, float* out) const;
+	static void evaluateKeyed(const BakedTrack& track, float frame, float* out);
+	// Rounds ints and normalizes quaternions after blending
+	static void finalize(const BakedTrack& track, float* out);
+
+	static u32 getComponentCount(ValueType type);
+	u64 getRowCount() const { return u64(frame_count) + 2; }
+	static u64 keyedSize(const BakedTrack& track);
+	u64 bakedSize(const BakedTrack& track) const;
+
+	void serialize(OutputMemoryStream& blob) const;
+	// Returns false if the blob has an unknown header or version, is truncated, or describes tracks
+	// that do not fit the sample buffer
+	bool deserialize(InputMemoryStream& blob);
+};
+
+} // namespace Lumix
@@ -1,9 +1,17 @@
 #define LUMIX_NO_CUSTOM_CRT
 #include "core/allocator.h"
+#include "core/log.h"
+#include "core/path.h"
+#include "core/span.h"
+#include "core/stream.h"
 #include "editor/studio_app.h"
 #include "editor/world_editor.h"
+#include "engine/engine.h"
+#include "engine/file_system.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_internal.h"
+#include "../baked_clip.h"
+#include <algorithm>
 #include <string>
 #include <variant>
 #include <vector>
@@ -64,6 +72,105 @@ struct EditorPlugin : StudioApp::GUIPlugin
 
 	std::vector<Track> tracks;
 
+	// Per-frame index of drawn keyframe rects: one bucket per track row, sorted by x
+	struct KeyframeHitIndex
+	{
+		struct Entry
+		{
+			float x;
+			int draw_order;
+			Keyframe* keyframe;
+			Track* track;
+		};
+
+		std::vector<std::vector<Entry>> rows;
+		// per row, positions in `rows[row]` listed in draw order
+		std::vector<std::vector<int>> draw_sequences;
+		float rows_top = 0.0f;
+		float row_height = 0.0f;
+		float radius = 0.0f;
+
+		void begin(size_t row_count, float top, float height, float key_radius)
+		{
+			rows.resize(row_count);
+			draw_sequences.resize(row_count);
+			for (std::vector<Entry>& row : rows) row.clear();
+			rows_top = top;
+			row_height = height;
+			radius = key_radius;
+		}
+
+		void add(size_t row, float x, Keyframe& kf, Track& track)
+		{
+			std::vector<Entry>& bucket = rows[row];
+			bucket.push_back({x, int(bucket.size()), &kf, &track});
+		}
+
+		void finalize()
+		{
+			for (size_t r = 0; r < rows.size(); ++r)
+			{
+				std::vector<Entry>& row = rows[r];
+				// keys are usually stored in frame order, so most rows are already sorted
+				auto by_x = [](const Entry& a, const Entry& b) { return a.x < b.x; };
+				if (!std::is_sorted(row.begin(), row.end(), by_x)) std::sort(row.begin(), row.end(), by_x);
+
+				std::vector<int>& sequence = draw_sequences[r];
+				sequence.resize(row.size());
+				for (size_t i = 0; i < row.size(); ++i) sequence[row[i].draw_order] = int(i);
+			}
+		}
+
+		float getRowCenterY(size_t row) const { return rows_top + (row + 0.5f) * row_height; }
+
+		// Returns the topmost (last drawn) keyframe under pos
+		const Entry* pick(const ImVec2& pos) const
+		{
+			if (row_height <= 0.0f || pos.y < rows_top) return nullptr;
+			size_t row = size_t((pos.y - rows_top) / row_height);
+			if (row >= rows.size()) return nullptr;
+
+			float center_y = getRowCenterY(row);
+			if (pos.y < center_y - radius || pos.y >= center_y + radius) return nullptr;
+
+			const std::vector<Entry>& bucket = rows[row];
+			auto it = std::lower_bound(
+				bucket.begin(), bucket.end(), pos.x - radius, [](const Entry& e, float x) { return e.x <= x; });
+
+			const Entry* best = nullptr;
+			for (; it != bucket.end() && it->x < pos.x + radius; ++it)
+			{
+				if (!best || it->draw_order > best->draw_order) best = &*it;
+			}
+			return best;
+		}
+
+		// Collects all keyframes whose rect overlaps rect, e.g. for marquee selection
+		void query(const ImRect& rect, std::vector<const Entry*>& out) const
+		{
+			if (row_height <= 0.0f) return;
+			for (size_t row = 0; row < rows.size(); ++row)
+			{
+				float center_y = getRowCenterY(row);
+				if (center_y + radius <= rect.Min.y || center_y - radius >= rect.Max.y) continue;
+
+				const std::vector<Entry>& bucket = rows[row];
+				auto it = std::lower_bound(
+					bucket.begin(), bucket.end(), rect.Min.x - radius, [](const Entry& e, float x) { return e.x <= x; });
+				for (; it != bucket.end() && it->x < rect.Max.x + radius; ++it)
+				{
+					out.push_back(&*it);
+				}
+			}
+		}
+	};
+
+	KeyframeHitIndex keyframe_hits;
+
+	BakedClip baked_clip;
+	u64 baked_clip_size = 0;
+	char baked_clip_path[MAX_PATH] = "animations/clip.ppclip";
+
 	Keyframe* selected_keyframe;
 	Track* selected_track;
 	Keyframe* dragging_keyframe;
@@ -87,6 +194,129 @@ struct EditorPlugin : StudioApp::GUIPlugin
 	static constexpr float KEYFRAME_RADIUS = 6.0f;		   
 	static constexpr float TIMELINE_HEADER_HEIGHT = 30.0f; 
 	static constexpr float TRACK_LABELS_WIDTH = 150.0f;	   
+	static constexpr float KEYFRAME_BORDER = 1.5f;
+	// Baked track may grow up to this many times its keyed size
+	static constexpr float MAX_BAKED_SIZE_RATIO = 64.0f;
+
+	// Keyframe glyph colors indexed by state: normal, hovered, selected
+	static constexpr ImU32 KEYFRAME_FILL_COLORS[] = {
+		IM_COL32(200, 150, 0, 255), IM_COL32(255, 180, 80, 255), IM_COL32(255, 200, 0, 255)};
+	static constexpr ImU32 KEYFRAME_BORDER_COLORS[] = {
+		IM_COL32(220, 170, 20, 255), IM_COL32(255, 220, 120, 255), IM_COL32(255, 255, 255, 255)};
+
+	// Keyframe glyph is a border diamond with an inset fill diamond on top
+	static constexpr int KEYFRAME_GLYPH_VTX_COUNT = 8;
+	static constexpr int KEYFRAME_GLYPH_IDX_COUNT = 12;
+	static constexpr int KEYFRAME_GLYPH_AA_VTX_COUNT = 12;
+	static constexpr int KEYFRAME_GLYPH_AA_IDX_COUNT = 36;
+	static constexpr float KEYFRAME_AA_SIZE = 1.0f;
+	// Largest batch a single PrimReserve can take with 16-bit indices
+	static constexpr int KEYFRAME_GLYPH_BATCH_MAX = (1 << 16) / KEYFRAME_GLYPH_AA_VTX_COUNT - 1;
+
+	// Writes one glyph into space already reserved with PrimReserve. Vertices are diamonds, from the outside in:
+	// transparent fringe, border, fill. The fringe ring is a 1px AA band against the background and is only
+	// written when anti_aliased is set.
+	static void writeKeyframeGlyph(
+		ImDrawList* draw_list, const ImVec2& center, ImU32 fill_color, ImU32 border_color, bool anti_aliased)
+	{
+		static const ImVec2 corners[] = {ImVec2(0, -1), ImVec2(1, 0), ImVec2(0, 1), ImVec2(-1, 0)};
+		static const ImDrawIdx indices[KEYFRAME_GLYPH_IDX_COUNT] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+		static const ImDrawIdx aa_indices[KEYFRAME_GLYPH_AA_IDX_COUNT] = {
+			4, 5, 6, 4, 6, 7, // border
+			8, 9, 10, 8, 10, 11, // fill
+			4, 5, 1, 4, 1, 0, 5, 6, 2, 5, 2, 1, 6, 7, 3, 6, 3, 2, 7, 4, 0, 7, 0, 3 // outer fringe
+		};
+		static const int rings[] = {1, 2};
+		static const int aa_rings[] = {0, 1, 2};
+
+		// diamond edges are at 45 degrees, so a perpendicular edge offset moves the corners by sqrt(2) times that
+		const float sqrt2 = 1.41421356f;
+		const float half_border = KEYFRAME_BORDER * 0.5f;
+		const float half_aa = anti_aliased ? KEYFRAME_AA_SIZE * 0.5f : 0.0f;
+		const float radii[] = {
+			KEYFRAME_RADIUS + (half_border + half_aa) * sqrt2,
+			KEYFRAME_RADIUS + (half_border - half_aa) * sqrt2,
+			KEYFRAME_RADIUS - half_border * sqrt2,
+		};
+		const ImU32 colors[] = {border_color & ~IM_COL32_A_MASK, border_color, fill_color};
+		const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+		const unsigned int base = draw_list->_VtxCurrentIdx;
+
+		const int* ring_list = anti_aliased ? aa_rings : rings;
+		const int ring_count = anti_aliased ? 3 : 2;
+		for (int r = 0; r < ring_count; ++r)
+		{
+			const int ring = ring_list[r];
+			for (const ImVec2& c : corners)
+			{
+				draw_list->PrimWriteVtx(
+					ImVec2(center.x + c.x * radii[ring], center.y + c.y * radii[ring]), uv, colors[ring]);
+			}
+		}
+
+		const ImDrawIdx* index_list = anti_aliased ? aa_indices : indices;
+		const int index_count = anti_aliased ? KEYFRAME_GLYPH_AA_IDX_COUNT : KEYFRAME_GLYPH_IDX_COUNT;
+		for (int i = 0; i < index_count; ++i)
+		{
+			draw_list->PrimWriteIdx(ImDrawIdx(base + index_list[i]));
+		}
+	}
+
+	// Rebuilds the hit index from the keyframes inside the visible x range
+	void buildKeyframeHits(float rows_top, float timeline_origin_x, float frame_width, float min_x, float max_x)
+	{
+		keyframe_hits.begin(tracks.size(), rows_top, TRACK_HEIGHT, KEYFRAME_RADIUS);
+		for (size_t t = 0; t < tracks.size(); ++t)
+		{
+			for (Keyframe& kf : tracks[t].keyframes)
+			{
+				float x = timeline_origin_x + kf.frame * frame_width;
+				if (x >= min_x && x <= max_x)
+				{
+					keyframe_hits.add(t, x, kf, tracks[t]);
+				}
+			}
+		}
+		keyframe_hits.finalize();
+	}
+
+	// Draws the indexed keyframes of one track row, one reserved batch of glyphs at a time. Rows with more glyphs
+	// than fit side by side in row_width are drawn without the AA fringe, since overlapping glyphs hide it anyway.
+	void drawKeyframeRow(ImDrawList* draw_list,
+		size_t row,
+		float track_y_center,
+		float row_width,
+		const KeyframeHitIndex::Entry* hovered_hit,
+		bool anti_aliased) const
+	{
+		anti_aliased = anti_aliased && keyframe_hits.rows[row].size() * 2 * KEYFRAME_RADIUS <= row_width;
+		const int vtx_count = anti_aliased ? KEYFRAME_GLYPH_AA_VTX_COUNT : KEYFRAME_GLYPH_VTX_COUNT;
+		const int idx_count = anti_aliased ? KEYFRAME_GLYPH_AA_IDX_COUNT : KEYFRAME_GLYPH_IDX_COUNT;
+		const std::vector<KeyframeHitIndex::Entry>& row_hits = keyframe_hits.rows[row];
+		const std::vector<int>& draw_sequence = keyframe_hits.draw_sequences[row];
+		for (size_t batch_start = 0; batch_start < draw_sequence.size(); batch_start += KEYFRAME_GLYPH_BATCH_MAX)
+		{
+			size_t batch_end = Lumix::minimum(draw_sequence.size(), batch_start + KEYFRAME_GLYPH_BATCH_MAX);
+			int batch_size = int(batch_end - batch_start);
+			draw_list->PrimReserve(batch_size * idx_count, batch_size * vtx_count);
+
+			for (size_t i = batch_start; i < batch_end; ++i)
+			{
+				const KeyframeHitIndex::Entry& hit = row_hits[draw_sequence[i]];
+				int state = 0;
+				if (selected_keyframe == hit.keyframe)
+					state = 2;
+				else if (hovered_hit == &hit)
+					state = 1;
+
+				writeKeyframeGlyph(draw_list,
+					ImVec2(hit.x, track_y_center),
+					KEYFRAME_FILL_COLORS[state],
+					KEYFRAME_BORDER_COLORS[state],
+					anti_aliased);
+			}
+		}
+	}
 
 	void onGUI() override
 	{
@@ -313,6 +543,60 @@ struct EditorPlugin : StudioApp::GUIPlugin
 				}
 			}
 
+			// Keyframe dragging - applied before hit-testing so picking and drawing see the same key positions
+			if (dragging_keyframe && ImGui::IsMouseDragging(0))
+			{
+				ImVec2 mouse_pos = ImGui::GetMousePos();
+				float timeline_x = mouse_pos.x - drag_offset_x;
+				float timeline_origin_x = timeline_start_x + timeline_offset;
+
+				int new_frame = int((timeline_x - timeline_origin_x) / frame_width + 0.5f);
+				new_frame = Lumix::clamp(new_frame, 0, frameCount);
+
+				if (dragging_keyframe->frame != new_frame)
+				{
+					dragging_keyframe->frame = new_frame;
+					invalidateBakedClip();
+				}
+			}
+
+			if (dragging_keyframe && ImGui::IsMouseReleased(0))
+			{
+				dragging_keyframe = nullptr;
+			}
+
+			// Keyframe hit-testing - index this frame's key rects, then resolve hover and clicks with one lookup
+			buildKeyframeHits(canvas_pos.y + TIMELINE_HEADER_HEIGHT,
+				timeline_start_x + timeline_offset,
+				frame_width,
+				timeline_start_x - 20,
+				canvas_pos.x + canvas_size.x + 20);
+
+			const KeyframeHitIndex::Entry* hovered_hit = nullptr;
+			ImRect canvas_rect(canvas_pos, ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y));
+			if (canvas_rect.Contains(ImGui::GetMousePos()))
+			{
+				hovered_hit = keyframe_hits.pick(ImGui::GetMousePos());
+			}
+			hovering_keyframe = hovered_hit != nullptr;
+
+			if (hovered_hit)
+			{
+				if (ImGui::IsMouseClicked(0))
+				{
+					selected_keyframe = hovered_hit->keyframe;
+					dragging_keyframe = hovered_hit->keyframe;
+					selected_track = hovered_hit->track;
+					drag_offset_x = ImGui::GetMousePos().x - hovered_hit->x;
+				}
+				if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))
+				{
+					selected_keyframe = hovered_hit->keyframe;
+					selected_track = hovered_hit->track;
+					ImGui::OpenPopup("KeyframeContextMenu");
+				}
+			}
+
 			// Track names
 			for (size_t t = 0; t < tracks.size(); ++t)
 			{
@@ -335,90 +619,19 @@ struct EditorPlugin : StudioApp::GUIPlugin
 				draw_list->AddText(text_pos, IM_COL32(220, 220, 220, 255), tracks[t].name.c_str());
 
 				// Track click handling
-				if (ImGui::IsMouseHoveringRect(track_bg_min, track_bg_max) && ImGui::IsMouseClicked(0))
+				if (!hovered_hit && ImGui::IsMouseHoveringRect(track_bg_min, track_bg_max) && ImGui::IsMouseClicked(0))
 				{
 					selected_track = &tracks[t];
 					selected_keyframe = nullptr;
 				}
 
-				// Keyframes
-				for (Keyframe& kf : tracks[t].keyframes)
-				{
-					float x = timeline_start_x + kf.frame * frame_width + timeline_offset;
-
-					if (x >= timeline_start_x - 20 && x <= canvas_pos.x + canvas_size.x + 20)
-					{
-						bool is_selected = (selected_keyframe == &kf);
-						bool is_hovered = false;
-
-						ImRect kf_rect(ImVec2(x - KEYFRAME_RADIUS, track_y_center - KEYFRAME_RADIUS),
-							ImVec2(x + KEYFRAME_RADIUS, track_y_center + KEYFRAME_RADIUS));
-
-						if (ImGui::IsMouseHoveringRect(kf_rect.Min, kf_rect.Max))
-						{
-							is_hovered = true;
-							hovering_keyframe = true;
-
-							if (ImGui::IsMouseClicked(0))
-							{
-								selected_keyframe = &kf;
-								dragging_keyframe = &kf;
-								selected_track = &tracks[t];
-
-								ImVec2 mouse_pos = ImGui::GetMousePos();
-								drag_offset_x = mouse_pos.x - x;
-							}
-							if (ImGui::IsMouseClicked(ImGuiMouseButton_Right))
-							{
-								selected_keyframe = &kf;
-								selected_track = &tracks[t];
-								ImGui::OpenPopup("KeyframeContextMenu");
-							}
-						}
-
-						
-						ImU32 kf_color;
-						ImU32 kf_border_color;
-
-						if (is_selected)
-						{
-							kf_color = IM_COL32(255, 200, 0, 255);
-							kf_border_color = IM_COL32(255, 255, 255, 255);
-						}
-						else if (is_hovered)
-						{
-							kf_color = IM_COL32(255, 180, 80, 255);
-							kf_border_color = IM_COL32(255, 220, 120, 255);
-						}
-						else
-						{
-							kf_color = IM_COL32(200, 150, 0, 255);
-							kf_border_color = IM_COL32(220, 170, 20, 255);
-						}
-
-						
-						draw_list->AddCircleFilled(ImVec2(x, track_y_center), KEYFRAME_RADIUS, kf_color);
-						draw_list->AddCircle(ImVec2(x, track_y_center), KEYFRAME_RADIUS, kf_border_color, 0, 1.5f);
-					}
-				}
-
-				
-				if (dragging_keyframe && ImGui::IsMouseDragging(0))
-				{
-					ImVec2 mouse_pos = ImGui::GetMousePos();
-					float timeline_x = mouse_pos.x - drag_offset_x;
-					float timeline_origin_x = timeline_start_x + timeline_offset;
-
-					int new_frame = int((timeline_x - timeline_origin_x) / frame_width + 0.5f);
-					new_frame = Lumix::clamp(new_frame, 0, frameCount);
-
-					dragging_keyframe->frame = new_frame;
-				}
-
-				if (dragging_keyframe && ImGui::IsMouseReleased(0))
-				{
-					dragging_keyframe = nullptr;
-				}
+				// Keyframes - glyphs go straight into the vertex buffer from the hit index
+				drawKeyframeRow(draw_list,
+					t,
+					track_y_center,
+					canvas_size.x - TRACK_LABELS_WIDTH,
+					hovered_hit,
+					ImGui::GetStyle().AntiAliasedFill);
 			}
 
 			// Context menu
@@ -438,6 +651,7 @@ struct EditorPlugin : StudioApp::GUIPlugin
 							keys.end());
 					}
 					selected_keyframe = nullptr;
+					invalidateBakedClip();
 				}
 
 				if (ImGui::MenuItem("Duplicate", "Ctrl+D"))
@@ -447,6 +661,7 @@ struct EditorPlugin : StudioApp::GUIPlugin
 						Keyframe new_kf = *selected_keyframe;
 						new_kf.frame += 5;
 						selected_track->keyframes.push_back(new_kf);
+						invalidateBakedClip();
 					}
 				}
 
@@ -510,7 +725,7 @@ struct EditorPlugin : StudioApp::GUIPlugin
 
 			ImGui::SameLine();
 			ImGui::SetNextItemWidth(60);
-			ImGui::InputInt("FPS##speed", &play_speed);
+			if (ImGui::InputInt("FPS##speed", &play_speed)) invalidateBakedClip();
 			play_speed = Lumix::clamp(play_speed, 1, 120);
 
 			// Splitter 
@@ -551,6 +766,25 @@ struct EditorPlugin : StudioApp::GUIPlugin
 			ImGui::Text("  Zoom: %.2fx", zoom);
 			ImGui::Text("  Offset: %.1fpx", timeline_offset);
 			ImGui::Text("  Frame Count: %d", frameCount);
+			ImGui::SetNextItemWidth(200);
+			ImGui::InputText("##baked_clip_path", baked_clip_path, sizeof(baked_clip_path));
+			ImGui::SameLine();
+			if (ImGui::Button("Bake for runtime"))
+			{
+				saveBakedClip();
+			}
+			if (ImGui::IsItemHovered()) ImGui::SetTooltip("Resample dense tracks to per-frame streams at the current FPS");
+			if (!baked_clip.tracks.empty())
+			{
+				int baked_count = 0;
+				for (const BakedClip::BakedTrack& track : baked_clip.tracks) baked_count += track.baked ? 1 : 0;
+				ImGui::SameLine();
+				ImGui::Text("%d/%d tracks baked, %d bytes @ %d FPS",
+					baked_count,
+					int(baked_clip.tracks.size()),
+					int(baked_clip_size),
+					baked_clip.sample_rate);
+			}
 			ImGui::Separator();
 
 			if (selected_keyframe && selected_track)
@@ -560,7 +794,7 @@ struct EditorPlugin : StudioApp::GUIPlugin
 				ImGui::Text("ID: %s", selected_track->id);
 
 				ImGui::SetNextItemWidth(100);
-				ImGui::InputInt("Frame", &selected_keyframe->frame);
+				bool edited = ImGui::InputInt("Frame", &selected_keyframe->frame);
 				selected_keyframe->frame = Lumix::clamp(selected_keyframe->frame, 0, frameCount);
 
 				std::visit(
@@ -570,30 +804,31 @@ struct EditorPlugin : StudioApp::GUIPlugin
 						if constexpr (std::is_same_v<T, float>)
 						{
 							ImGui::SetNextItemWidth(150);
-							ImGui::InputFloat("Value", &val);
+							edited |= ImGui::InputFloat("Value", &val);
 						}
 						else if constexpr (std::is_same_v<T, int>)
 						{
 							ImGui::SetNextItemWidth(150);
-							ImGui::DragInt("Value", &val);
+							edited |= ImGui::DragInt("Value", &val);
 						}
 						else if constexpr (std::is_same_v<T, Vec2>)
 						{
 							ImGui::SetNextItemWidth(200);
-							ImGui::InputFloat2("Value", &val.x);
+							edited |= ImGui::InputFloat2("Value", &val.x);
 						}
 						else if constexpr (std::is_same_v<T, Vec3>)
 						{
 							ImGui::SetNextItemWidth(250);
-							ImGui::InputFloat3("Value", &val.x);
+							edited |= ImGui::InputFloat3("Value", &val.x);
 						}
 						else if constexpr (std::is_same_v<T, Quat>)
 						{
 							ImGui::SetNextItemWidth(300);
-							ImGui::InputFloat4("Value", &val.x);
+							edited |= ImGui::InputFloat4("Value", &val.x);
 						}
 					},
 					selected_keyframe->value);
+				if (edited) invalidateBakedClip();
 			}
 			else if (selected_track)
 			{
@@ -627,6 +862,214 @@ struct EditorPlugin : StudioApp::GUIPlugin
 		return {frame, 0.0f};
 	}
 
+	static BakedClip::ValueType toBakedType(Track::ValueType type)
+	{
+		switch (type)
+		{
+			case Track::ValueType::Float: return BakedClip::ValueType::Float;
+			case Track::ValueType::Int: return BakedClip::ValueType::Int;
+			case Track::ValueType::Vec2: return BakedClip::ValueType::Vec2;
+			case Track::ValueType::Vec3: return BakedClip::ValueType::Vec3;
+			case Track::ValueType::Quat: return BakedClip::ValueType::Quat;
+		}
+		ASSERT(false);
+		return BakedClip::ValueType::Float;
+	}
+
+	static void getComponents(const Keyframe& kf, float* out)
+	{
+		std::visit(
+			[&](const auto& val)
+			{
+				using T = std::decay_t<decltype(val)>;
+				if constexpr (std::is_same_v<T, float>)
+					out[0] = val;
+				else if constexpr (std::is_same_v<T, int>)
+					out[0] = float(val);
+				else
+					memcpy(out, &val.x, sizeof(T));
+			},
+			kf.value);
+	}
+
+	// Fills clip with every track in keyed form, keys sorted by frame. Quaternion keys are flipped onto the
+	// hemisphere of the previous key, so blending takes the short way and opposite keys do not cancel out.
+	void buildKeyedClip(BakedClip& clip) const
+	{
+		clip = BakedClip();
+		clip.frame_count = frameCount;
+		clip.sample_rate = play_speed;
+
+		for (const Track& src : tracks)
+		{
+			BakedClip::BakedTrack& track = clip.tracks.emplace_back();
+			track.type = toBakedType(src.type);
+			track.components = BakedClip::getComponentCount(track.type);
+			track.column = clip.stride;
+			clip.stride += track.components;
+
+			std::vector<Keyframe> keys = src.keyframes;
+			std::stable_sort(
+				keys.begin(), keys.end(), [](const Keyframe& a, const Keyframe& b) { return a.frame < b.frame; });
+			track.frames.resize(keys.size());
+			track.values.resize(keys.size() * track.components);
+			for (size_t i = 0; i < keys.size(); ++i)
+			{
+				track.frames[i] = keys[i].frame;
+				float* value = &track.values[i * track.components];
+				getComponents(keys[i], value);
+
+				if (track.type == BakedClip::ValueType::Quat && i > 0)
+				{
+					const float* prev = value - track.components;
+					float dot = prev[0] * value[0] + prev[1] * value[1] + prev[2] * value[2] + prev[3] * value[3];
+					if (dot < 0)
+					{
+						for (u32 c = 0; c < 4; ++c) value[c] = -value[c];
+					}
+				}
+			}
+		}
+	}
+
+	// Converts the clip to its shipping form. The choice per track is made on size alone: a baked track costs one row
+	// read per evaluation whatever its key count, which is never slower than the keyed binary search, so every track
+	// is baked unless its baked size exceeds MAX_BAKED_SIZE_RATIO times its keyed size.
+	void bakeClip(BakedClip& clip) const
+	{
+		buildKeyedClip(clip);
+
+		// sample every frame from the keys, then quantize each component to its own range
+		const u32 row_count = u32(clip.getRowCount());
+		std::vector<float> raw(row_count * clip.stride);
+		for (u32 f = 0; f < row_count; ++f)
+		{
+			float frame = float(Lumix::minimum(int(f), frameCount));
+			for (const BakedClip::BakedTrack& track : clip.tracks)
+			{
+				BakedClip::evaluateKeyed(track, frame, &raw[f * clip.stride + track.column]);
+			}
+		}
+
+		clip.samples.resize(raw.size());
+		for (BakedClip::BakedTrack& track : clip.tracks)
+		{
+			for (u32 c = 0; c < track.components; ++c)
+			{
+				float lo = raw[track.column + c];
+				float hi = lo;
+				for (u32 f = 1; f < row_count; ++f)
+				{
+					lo = Lumix::minimum(lo, raw[f * clip.stride + track.column + c]);
+					hi = Lumix::maximum(hi, raw[f * clip.stride + track.column + c]);
+				}
+				track.min[c] = lo;
+				track.scale[c] = (hi - lo) / 65535.0f;
+				float inv_scale = hi > lo ? 65535.0f / (hi - lo) : 0.0f;
+				for (u32 f = 0; f < row_count; ++f)
+				{
+					u32 idx = f * clip.stride + track.column + c;
+					clip.samples[idx] = u16((raw[idx] - lo) * inv_scale + 0.5f);
+				}
+			}
+		}
+
+		for (BakedClip::BakedTrack& track : clip.tracks)
+		{
+			track.baked = clip.bakedSize(track) <= BakedClip::keyedSize(track) * MAX_BAKED_SIZE_RATIO;
+		}
+
+		// compact the sample buffer down to the columns of baked tracks
+		u32 baked_stride = 0;
+		for (BakedClip::BakedTrack& track : clip.tracks)
+		{
+			if (track.baked)
+			{
+				track.frames.clear();
+				track.values.clear();
+			}
+			baked_stride += track.baked ? track.components : 0;
+		}
+
+		std::vector<u16> baked_samples(row_count * baked_stride);
+		u32 column = 0;
+		for (BakedClip::BakedTrack& track : clip.tracks)
+		{
+			if (!track.baked) continue;
+			for (u32 f = 0; f < row_count; ++f)
+			{
+				memcpy(&baked_samples[f * baked_stride + column],
+					&clip.samples[f * clip.stride + track.column],
+					track.components * sizeof(u16));
+			}
+			track.column = column;
+			column += track.components;
+		}
+		clip.stride = baked_stride;
+		clip.samples = std::move(baked_samples);
+	}
+
+	// Checks a loaded clip against the keys it was baked from; baked tracks may differ by the quantization step
+	static bool verifyBakedClip(const BakedClip& reference, const BakedClip& loaded)
+	{
+		if (loaded.tracks.size() != reference.tracks.size() || loaded.frame_count != reference.frame_count) return false;
+
+		for (size_t t = 0; t < loaded.tracks.size(); ++t)
+		{
+			const BakedClip::BakedTrack& track = loaded.tracks[t];
+			for (int f = 0; f <= loaded.frame_count; ++f)
+			{
+				float expected[4];
+				float value[4];
+				BakedClip::evaluateKeyed(reference.tracks[t], float(f), expected);
+				if (track.baked)
+					loaded.evaluateBaked(track, float(f), value);
+				else
+					BakedClip::evaluateKeyed(track, float(f), value);
+
+				for (u32 c = 0; c < track.components; ++c)
+				{
+					float tolerance = track.baked ? track.scale[c] * 0.5f : 0.0f;
+					tolerance += 1e-5f * Lumix::maximum(1.0f, expected[c] < 0 ? -expected[c] : expected[c]);
+					float diff = value[c] - expected[c];
+					if (diff > tolerance || diff < -tolerance) return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void saveBakedClip()
+	{
+		IAllocator& allocator = m_app.getWorldEditor().getAllocator();
+		bakeClip(baked_clip);
+		OutputMemoryStream blob(allocator);
+		baked_clip.serialize(blob);
+		baked_clip_size = blob.size();
+
+#ifdef LUMIX_DEBUG
+		BakedClip reference;
+		buildKeyedClip(reference);
+		BakedClip loaded;
+		InputMemoryStream input(blob);
+		bool loaded_ok = loaded.deserialize(input);
+		ASSERT(loaded_ok && verifyBakedClip(reference, loaded));
+#endif
+
+		FileSystem& fs = m_app.getEngine().getFileSystem();
+		if (!fs.saveContentSync(Path(baked_clip_path), Span<const u8>(blob.data(), (u32)blob.size())))
+		{
+			logError("Failed to save baked clip ", baked_clip_path);
+		}
+	}
+
+	// Baked data describes the tracks at bake time, so it is dropped on any edit
+	void invalidateBakedClip()
+	{
+		baked_clip = BakedClip();
+		baked_clip_size = 0;
+	}
+
 	void SetProperties(Quat rot) {}
 
 	const char* getName() const override { return "proproperty"; }